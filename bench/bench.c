@@ -0,0 +1,278 @@
+/*CPU pinning uses the Linux affinity API, elsewhere we only need POSIX clocks*/
+#ifdef __linux__
+#define _GNU_SOURCE
+#include <sched.h>
+#else
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <assert.h>
+#include <errno.h>
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+#include "xallocs.h"
+
+#ifdef __linux__
+/*cpu_set_t can only address CPU_SETSIZE CPUs*/
+#define BENCH_MAX_CPU (CPU_SETSIZE - 1)
+#else
+#define BENCH_MAX_CPU INT_MAX
+#endif
+
+struct bench_stats {
+  double min, max, mean, median, mad, p90, p99;
+};
+
+static void print_usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [--warmup N] [--runs N] [--cpu N] [--buildtype NAME] "
+          "[--json FILE]\n",
+          prog);
+}
+
+static int parse_num(const char *str, long long min, long long max,
+                     long long *out) {
+  char *end = NULL;
+  errno = 0;
+  long long val = strtoll(str, &end, 10);
+  if (errno || end == str || *end != '\0' || val < min || val > max) {
+    return -1;
+  }
+  *out = val;
+  return 0;
+}
+
+int bench_parse_args(struct bench_config *cfg, int argc, char **argv) {
+  assert(cfg);
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    long long num = 0;
+
+    if (!val) {
+      print_usage(argv[0]);
+      return -1;
+    }
+    if (!strcmp(arg, "--json")) {
+      cfg->json_path = val;
+    } else if (!strcmp(arg, "--buildtype") && !strpbrk(val, "\"\\")) {
+      /*Written into the JSON as is, so don't allow anything to escape*/
+      cfg->buildtype = val;
+    } else if (!strcmp(arg, "--warmup") &&
+               !parse_num(val, 0, UINT32_MAX, &num)) {
+      cfg->warmup = num;
+    } else if (!strcmp(arg, "--runs") &&
+               !parse_num(val, 1, UINT32_MAX, &num)) {
+      cfg->runs = num;
+    } else if (!strcmp(arg, "--cpu") &&
+               !parse_num(val, -1, BENCH_MAX_CPU, &num)) {
+      cfg->cpu = num;
+    } else {
+      print_usage(argv[0]);
+      return -1;
+    }
+    i++;
+  }
+  return 0;
+}
+
+void bench_pin_cpu(const struct bench_config *cfg) {
+  if (cfg->cpu < 0) {
+    return;
+  }
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cfg->cpu, &set);
+  if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+    fprintf(stderr, "Could not pin to CPU %i: %s\n", cfg->cpu,
+            strerror(errno));
+  }
+#else
+  fprintf(stderr, "CPU pinning is unsupported on this platform\n");
+#endif
+}
+
+uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+void bench_result_init(struct bench_result *res, const char *name,
+                       uint64_t items, uint32_t runs) {
+  res->name = name;
+  res->items = items;
+  res->count = 0;
+  res->capacity = runs;
+  res->samples = xarray(double, runs);
+}
+
+void bench_result_add(struct bench_result *res, double ns) {
+  if (res->count == res->capacity) {
+    res->capacity *= 2;
+    res->samples = xrealloc(res->samples, sizeof(double) * res->capacity);
+  }
+  res->samples[res->count++] = ns;
+}
+
+void bench_result_free(struct bench_result *res) {
+  xfree(res->samples);
+  res->samples = NULL;
+  res->count = res->capacity = 0;
+}
+
+void bench_run(const struct bench_config *cfg, struct bench_result *res,
+               bench_fn fn, void *state) {
+  for (uint32_t i = 0; i < cfg->warmup; i++) {
+    fn(state);
+  }
+  for (uint32_t i = 0; i < cfg->runs; i++) {
+    uint64_t start = bench_now_ns();
+    fn(state);
+    bench_result_add(res, (double)(bench_now_ns() - start));
+  }
+}
+
+static int cmp_double(const void *a, const void *b) {
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+/* Linear interpolation between the closest ranks, sorted must be sorted */
+static double percentile(const double *sorted, uint32_t n, double p) {
+  double pos = p * (n - 1);
+  uint32_t lo = (uint32_t)pos;
+  uint32_t hi = lo + 1 < n ? lo + 1 : lo;
+  return sorted[lo] + (sorted[hi] - sorted[lo]) * (pos - lo);
+}
+
+static void compute_stats(const struct bench_result *res,
+                          struct bench_stats *stats) {
+  uint32_t n = res->count;
+  memset(stats, 0, sizeof(*stats));
+  if (n == 0) {
+    return;
+  }
+
+  double *sorted = xarray(double, n);
+  memcpy(sorted, res->samples, sizeof(double) * n);
+  qsort(sorted, n, sizeof(double), cmp_double);
+
+  double sum = 0;
+  for (uint32_t i = 0; i < n; i++) {
+    sum += sorted[i];
+  }
+  stats->min = sorted[0];
+  stats->max = sorted[n - 1];
+  stats->mean = sum / n;
+  stats->median = percentile(sorted, n, 0.5);
+  stats->p90 = percentile(sorted, n, 0.9);
+  stats->p99 = percentile(sorted, n, 0.99);
+
+  /*Reuse the buffer for the absolute deviations from the median*/
+  for (uint32_t i = 0; i < n; i++) {
+    sorted[i] = fabs(sorted[i] - stats->median);
+  }
+  qsort(sorted, n, sizeof(double), cmp_double);
+  stats->mad = percentile(sorted, n, 0.5);
+  xfree(sorted);
+}
+
+static double items_per_sec(const struct bench_result *res, double ns) {
+  return ns > 0 ? (double)res->items * 1e9 / ns : 0;
+}
+
+static void write_json_header(FILE *fp, const struct bench_config *cfg) {
+  fprintf(fp, "{\n  \"suite\": \"%s\",\n", cfg->suite);
+  fprintf(fp,
+          "  \"config\": {\"warmup\": %u, \"runs\": %u, \"cpu\": %i, "
+          "\"buildtype\": \"%s\"},\n",
+          cfg->warmup, cfg->runs, cfg->cpu,
+          cfg->buildtype ? cfg->buildtype : "unknown");
+}
+
+void bench_clear_json(const struct bench_config *cfg) {
+  if (cfg->json_path && remove(cfg->json_path) < 0 && errno != ENOENT) {
+    fprintf(stderr, "Could not remove %s: %s\n", cfg->json_path,
+            strerror(errno));
+  }
+}
+
+int bench_skip(const struct bench_config *cfg, const char *reason) {
+  fprintf(stderr, "%s, skipping\n", reason);
+  if (!cfg->json_path) {
+    return BENCH_EXIT_SKIP;
+  }
+  FILE *fp = fopen(cfg->json_path, "w");
+  if (!fp) {
+    fprintf(stderr, "Could not open %s: %s\n", cfg->json_path,
+            strerror(errno));
+    return BENCH_EXIT_SKIP;
+  }
+  /*reason is a fixed string from our own code, no escaping needed*/
+  write_json_header(fp, cfg);
+  fprintf(fp, "  \"skipped\": true,\n  \"reason\": \"%s\",\n", reason);
+  fprintf(fp, "  \"results\": []\n}\n");
+  fclose(fp);
+  return BENCH_EXIT_SKIP;
+}
+
+static int write_json(const struct bench_config *cfg,
+                      const struct bench_result *results,
+                      const struct bench_stats *stats, uint32_t count) {
+  FILE *fp = fopen(cfg->json_path, "w");
+  if (!fp) {
+    fprintf(stderr, "Could not open %s: %s\n", cfg->json_path,
+            strerror(errno));
+    return -1;
+  }
+  write_json_header(fp, cfg);
+  fprintf(fp, "  \"skipped\": false,\n");
+  fprintf(fp, "  \"results\": [\n");
+  for (uint32_t i = 0; i < count; i++) {
+    const struct bench_stats *s = &stats[i];
+    fprintf(fp,
+            "    {\"name\": \"%s\", \"unit\": \"ns\", \"items\": %llu, "
+            "\"runs\": %u, \"min\": %.1f, \"max\": %.1f, \"mean\": %.1f, "
+            "\"median\": %.1f, \"mad\": %.1f, \"p90\": %.1f, \"p99\": %.1f, "
+            "\"items_per_sec\": %.1f}%s\n",
+            results[i].name, (unsigned long long)results[i].items,
+            results[i].count, s->min, s->max, s->mean, s->median, s->mad,
+            s->p90, s->p99, items_per_sec(&results[i], s->median),
+            i + 1 < count ? "," : "");
+  }
+  fprintf(fp, "  ]\n}\n");
+  if (fclose(fp) != 0) {
+    fprintf(stderr, "Could not write %s\n", cfg->json_path);
+    return -1;
+  }
+  return 0;
+}
+
+int bench_report(const struct bench_config *cfg,
+                 const struct bench_result *results, uint32_t count) {
+  struct bench_stats *stats = xarray(struct bench_stats, count);
+
+  printf("%-32s %12s %10s %12s %12s %14s\n", "benchmark", "median(ns)",
+         "mad(ns)", "p90(ns)", "p99(ns)", "items/s");
+  for (uint32_t i = 0; i < count; i++) {
+    compute_stats(&results[i], &stats[i]);
+    printf("%-32s %12.0f %10.0f %12.0f %12.0f %14.0f\n", results[i].name,
+           stats[i].median, stats[i].mad, stats[i].p90, stats[i].p99,
+           items_per_sec(&results[i], stats[i].median));
+  }
+
+  int ret = 0;
+  if (cfg->json_path) {
+    ret = write_json(cfg, results, stats, count);
+  }
+  xfree(stats);
+  return ret;
+}
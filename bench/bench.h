@@ -0,0 +1,66 @@
+#ifndef _H_BENCH_
+#define _H_BENCH_
+
+#include <stdint.h>
+
+/* Small benchmark harness shared by all bench_* executables. Every case is
+ * run a number of warmup iterations that are thrown away, followed by the
+ * measured runs. Results are summarized with median, MAD and percentiles since
+ * those are robust against the odd scheduler hiccup, unlike mean/stddev. */
+
+struct bench_config {
+  const char *suite;
+  const char *json_path; /*NULL means no JSON output*/
+  const char *buildtype; /*Recorded in the JSON config, NULL is "unknown"*/
+  uint32_t warmup;
+  uint32_t runs;
+  int cpu; /*-1 means no pinning*/
+};
+
+struct bench_result {
+  const char *name;
+  /*Number of operations done per run, used for the throughput figure*/
+  uint64_t items;
+  uint32_t count;
+  uint32_t capacity;
+  double *samples; /*Wall time of each run in nanoseconds*/
+};
+
+typedef void (*bench_fn)(void *state);
+
+/* Exit code understood by meson as "skipped" */
+#define BENCH_EXIT_SKIP 77
+
+/* Parses --warmup N, --runs N, --cpu N, --buildtype NAME and --json FILE. Returns -1 and prints
+ * usage on malformed arguments. */
+int bench_parse_args(struct bench_config *cfg, int argc, char **argv);
+
+/* Pins the calling thread to cfg->cpu. Failing to pin is not fatal, we just
+ * get noisier numbers. */
+void bench_pin_cpu(const struct bench_config *cfg);
+
+uint64_t bench_now_ns(void);
+
+void bench_result_init(struct bench_result *res, const char *name,
+                       uint64_t items, uint32_t runs);
+void bench_result_add(struct bench_result *res, double ns);
+void bench_result_free(struct bench_result *res);
+
+/* Runs fn cfg->warmup times untimed and then cfg->runs times timed */
+void bench_run(const struct bench_config *cfg, struct bench_result *res,
+               bench_fn fn, void *state);
+
+/* Removes cfg->json_path left over from an earlier run, so a benchmark that
+ * fails before reporting doesn't leave stale numbers behind */
+void bench_clear_json(const struct bench_config *cfg);
+
+/* Prints reason, marks the suite as skipped in cfg->json_path if set and
+ * returns BENCH_EXIT_SKIP */
+int bench_skip(const struct bench_config *cfg, const char *reason);
+
+/* Prints a summary table to stdout and writes cfg->json_path if set.
+ * Returns -1 if the JSON file could not be written. */
+int bench_report(const struct bench_config *cfg,
+                 const struct bench_result *results, uint32_t count);
+
+#endif
@@ -0,0 +1,69 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+#include "hmacros.h"
+#include "xallocs.h"
+
+#define ALLOCS_PER_RUN 4096
+#define REALLOC_STEPS 4096
+#define REALLOC_STEP_SIZE 64
+
+struct alloc_state {
+  void *ptrs[ALLOCS_PER_RUN];
+};
+
+/* Small short lived arrays, the pattern vulkan_context.c uses for extension,
+ * layer and queue family lists. Every block is touched so the compiler can't
+ * elide the malloc/free pair. */
+static void alloc_small(void *state) {
+  struct alloc_state *s = state;
+  for (uint32_t i = 0; i < ALLOCS_PER_RUN; i++) {
+    size_t size = 16 + (i % 16) * 16;
+    s->ptrs[i] = xmalloc(size);
+    memset(s->ptrs[i], (int)i, size);
+  }
+  for (uint32_t i = 0; i < ALLOCS_PER_RUN; i++) {
+    xfree(s->ptrs[i]);
+  }
+}
+
+/*Growing a single buffer in small fixed steps instead of doubling*/
+static void realloc_grow(void *state) {
+  (void)state;
+  char *buf = NULL;
+  for (uint32_t i = 1; i <= REALLOC_STEPS; i++) {
+    buf = xrealloc(buf, i * REALLOC_STEP_SIZE);
+    buf[(i - 1) * REALLOC_STEP_SIZE] = (char)i;
+  }
+  xfree(buf);
+}
+
+int main(int argc, char **argv) {
+  struct bench_config cfg = {
+      .suite = "alloc", .json_path = NULL, .warmup = 5, .runs = 50, .cpu = -1};
+  if (bench_parse_args(&cfg, argc, argv) < 0) {
+    return EXIT_FAILURE;
+  }
+  bench_clear_json(&cfg);
+  bench_pin_cpu(&cfg);
+
+  struct alloc_state *state = xarray(struct alloc_state, 1);
+
+  struct bench_result results[2];
+  bench_result_init(&results[0], "alloc/xmalloc_small", ALLOCS_PER_RUN,
+                    cfg.runs);
+  bench_run(&cfg, &results[0], alloc_small, state);
+  bench_result_init(&results[1], "alloc/xrealloc_grow", REALLOC_STEPS,
+                    cfg.runs);
+  bench_run(&cfg, &results[1], realloc_grow, state);
+
+  int ret = bench_report(&cfg, results, ASIZE(results));
+
+  for (uint32_t i = 0; i < ASIZE(results); i++) {
+    bench_result_free(&results[i]);
+  }
+  xfree(state);
+  return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
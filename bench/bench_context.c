@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#define GLFW_INCLUDE_VULKAN
+#include <GLFW/glfw3.h>
+
+#include "bench.h"
+#include "hmacros.h"
+#include "vulkan_context.h"
+
+/* Phases reported by init_vulkan_context with validation disabled, in order.
+ * Each phase is timed from the end of the previous one. */
+static const enum vulkan_context_phase phases[] = {
+    VKCTX_PHASE_WINDOW, VKCTX_PHASE_INSTANCE, VKCTX_PHASE_SURFACE,
+    VKCTX_PHASE_PHYSICAL_DEVICE, VKCTX_PHASE_LOGICAL_DEVICE};
+
+enum {
+  RES_TOTAL = ASIZE(phases),
+  RES_DESTROY,
+  RES_COUNT,
+};
+
+struct phase_state {
+  uint64_t last;
+  uint64_t durations[VKCTX_PHASE_COUNT];
+  uint32_t reported; /*Bitmask of reported phases*/
+  int invalid;       /*Set if a phase outside of the enum was reported*/
+};
+
+static void on_phase_done(enum vulkan_context_phase phase, void *user_data) {
+  struct phase_state *s = user_data;
+  uint64_t now = bench_now_ns();
+  if ((unsigned)phase >= VKCTX_PHASE_COUNT) {
+    s->invalid = 1;
+    return;
+  }
+  s->durations[phase] = now - s->last;
+  s->reported |= 1u << phase;
+  s->last = now;
+}
+
+/* A phase that was added, removed or never reported would otherwise end up in
+ * the results as a bogus sample */
+static int check_phases(const struct phase_state *s) {
+  uint32_t expected = 0;
+  for (uint32_t p = 0; p < ASIZE(phases); p++) {
+    expected |= 1u << phases[p];
+  }
+  if (s->invalid || s->reported != expected) {
+    fprintf(stderr, "Unexpected phases reported: got 0x%x, expected 0x%x\n",
+            s->reported, expected);
+    return -1;
+  }
+  return 0;
+}
+
+/* The meson benchmark points the loader at a specific ICD manifest. If that
+ * file is missing the loader silently falls back to nothing, so check it up
+ * front and report it instead of a generic context failure. */
+static int icd_manifest_available(void) {
+  const char *icd = getenv("VK_DRIVER_FILES");
+  if (!icd || !*icd) {
+    icd = getenv("VK_ICD_FILENAMES");
+  }
+  if (!icd || !*icd) {
+    /*No override, use whatever driver the system provides*/
+    return 1;
+  }
+  FILE *fp = fopen(icd, "r");
+  if (!fp) {
+    fprintf(stderr, "Vulkan ICD manifest %s not found\n", icd);
+    return 0;
+  }
+  fclose(fp);
+  return 1;
+}
+
+int main(int argc, char **argv) {
+  struct bench_config cfg = {
+      .suite = "context", .json_path = NULL, .warmup = 2, .runs = 20, .cpu = -1};
+  if (bench_parse_args(&cfg, argc, argv) < 0) {
+    return EXIT_FAILURE;
+  }
+  bench_clear_json(&cfg);
+  bench_pin_cpu(&cfg);
+
+  /*Without a display server or a vulkan driver there is nothing to measure*/
+  if (!icd_manifest_available()) {
+    return bench_skip(&cfg, "Vulkan ICD manifest not found");
+  }
+  if (!glfwInit()) {
+    return bench_skip(&cfg, "Could not initialize GLFW");
+  }
+  if (!glfwVulkanSupported()) {
+    glfwTerminate();
+    return bench_skip(&cfg, "No vulkan loader or driver found");
+  }
+
+  struct phase_state state;
+  struct vulkan_context_opts opts = {.w_opts = {.width = 640,
+                                                .height = 400,
+                                                .title = "bench_context",
+                                                .resizable = 0},
+                                     .d_opts = {NULL},
+                                     .enable_validation = 0,
+                                     .phase_done = on_phase_done,
+                                     .phase_user_data = &state};
+
+  static char names[RES_COUNT][64];
+  for (uint32_t p = 0; p < ASIZE(phases); p++) {
+    snprintf(names[p], sizeof(names[p]), "context/%s",
+             vulkan_context_phase_name(phases[p]));
+  }
+  snprintf(names[RES_TOTAL], sizeof(names[RES_TOTAL]), "context/init_total");
+  snprintf(names[RES_DESTROY], sizeof(names[RES_DESTROY]), "context/destroy");
+
+  struct bench_result results[RES_COUNT];
+  for (uint32_t i = 0; i < RES_COUNT; i++) {
+    bench_result_init(&results[i], names[i], 1, cfg.runs);
+  }
+
+  int ret = EXIT_SUCCESS;
+  for (uint64_t i = 0; i < (uint64_t)cfg.warmup + cfg.runs; i++) {
+    vulkan_context *vkctx;
+    memset(&state, 0, sizeof(state));
+    uint64_t start = bench_now_ns();
+    state.last = start;
+    /*The environment was checked above, so any failure here is the code
+     * under test breaking*/
+    if (init_vulkan_context(&vkctx, &opts) < 0) {
+      fprintf(stderr, "Vulkan context creation failed in run %llu\n",
+              (unsigned long long)i);
+      ret = EXIT_FAILURE;
+      goto exit_free_results;
+    }
+    uint64_t init_end = bench_now_ns();
+    destroy_vulkan_context(vkctx);
+    uint64_t destroy_end = bench_now_ns();
+
+    if (check_phases(&state) < 0) {
+      ret = EXIT_FAILURE;
+      goto exit_free_results;
+    }
+
+    if (i < cfg.warmup) {
+      continue;
+    }
+    for (uint32_t p = 0; p < ASIZE(phases); p++) {
+      bench_result_add(&results[p], (double)state.durations[phases[p]]);
+    }
+    bench_result_add(&results[RES_TOTAL], (double)(init_end - start));
+    bench_result_add(&results[RES_DESTROY], (double)(destroy_end - init_end));
+  }
+
+  if (bench_report(&cfg, results, RES_COUNT) < 0) {
+    ret = EXIT_FAILURE;
+  }
+exit_free_results:
+  for (uint32_t i = 0; i < RES_COUNT; i++) {
+    bench_result_free(&results[i]);
+  }
+  glfwTerminate();
+  return ret;
+}
@@ -0,0 +1,70 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "bench.h"
+#include "hmacros.h"
+#include "log.h"
+
+#define MESSAGES_PER_RUN 10000
+
+struct log_state {
+  struct log log;
+  int rewind; /*Rewind fp before every run so file backed logs don't grow*/
+};
+
+static void log_formatted(void *state) {
+  struct log_state *s = state;
+  if (s->rewind) {
+    rewind(s->log.fp);
+  }
+  for (uint32_t i = 0; i < MESSAGES_PER_RUN; i++) {
+    write_log(&s->log, VER_INFO, "Frame #%u took %.3fms, %s\n", i, i * 0.016,
+              "VK_SUCCESS");
+  }
+}
+
+/*Messages above the log verbosity, this should only cost the level check*/
+static void log_filtered(void *state) {
+  struct log_state *s = state;
+  for (uint32_t i = 0; i < MESSAGES_PER_RUN; i++) {
+    write_log(&s->log, VER_DEBUG, "Frame #%u took %.3fms, %s\n", i, i * 0.016,
+              "VK_SUCCESS");
+  }
+}
+
+int main(int argc, char **argv) {
+  struct bench_config cfg = {
+      .suite = "log", .json_path = NULL, .warmup = 5, .runs = 50, .cpu = -1};
+  if (bench_parse_args(&cfg, argc, argv) < 0) {
+    return EXIT_FAILURE;
+  }
+  bench_clear_json(&cfg);
+  bench_pin_cpu(&cfg);
+
+  FILE *devnull = fopen("/dev/null", "w");
+  FILE *tmp = tmpfile();
+  if (!devnull || !tmp) {
+    fprintf(stderr, "Could not open log sinks\n");
+    return EXIT_FAILURE;
+  }
+
+  struct log_state devnull_state = {{devnull, VER_INFO}, 0};
+  struct log_state tmp_state = {{tmp, VER_INFO}, 1};
+
+  struct bench_result results[3];
+  bench_result_init(&results[0], "log/devnull", MESSAGES_PER_RUN, cfg.runs);
+  bench_run(&cfg, &results[0], log_formatted, &devnull_state);
+  bench_result_init(&results[1], "log/tmpfile", MESSAGES_PER_RUN, cfg.runs);
+  bench_run(&cfg, &results[1], log_formatted, &tmp_state);
+  bench_result_init(&results[2], "log/filtered", MESSAGES_PER_RUN, cfg.runs);
+  bench_run(&cfg, &results[2], log_filtered, &devnull_state);
+
+  int ret = bench_report(&cfg, results, ASIZE(results));
+
+  for (uint32_t i = 0; i < ASIZE(results); i++) {
+    bench_result_free(&results[i]);
+  }
+  fclose(tmp);
+  fclose(devnull);
+  return ret < 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#!/usr/bin/env python3
+"""Compare benchmark JSON output against a stored baseline.
+
+Usage:
+  compare.py BASELINE RESULT.json...            report, exit 1 on regression
+  compare.py --update BASELINE RESULT.json...   store results as new baseline
+
+A benchmark regresses when its median is more than --threshold slower than
+the baseline median AND the difference exceeds --mad-factor times the larger
+MAD of both runs, so noisy benchmarks don't trip on jitter alone.
+Results built with a different buildtype than the baseline are not compared
+and fail, since -O0 and -O2 numbers say nothing about each other.
+
+Skipped suites and baseline results missing from RESULT.json also fail the
+comparison, unless --allow-skipped or --allow-missing is given.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load_results(paths):
+    """Returns (results by name, names of skipped suites)"""
+    results = {}
+    skipped = set()
+    for path in paths:
+        with open(path) as f:
+            data = json.load(f)
+        if data.get("skipped"):
+            skipped.add(data["suite"])
+            print(f"Suite {data['suite']} was skipped: {data.get('reason', '')}")
+        for res in data["results"]:
+            res.setdefault("suite", data.get("suite"))
+            res.setdefault("buildtype",
+                           data.get("config", {}).get("buildtype", "unknown"))
+            results[res["name"]] = res
+    return results, skipped
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("results", nargs="+")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="relative slowdown of the median that counts as regression")
+    parser.add_argument("--mad-factor", type=float, default=3.0,
+                        help="slowdown must also exceed this many MADs")
+    parser.add_argument("--allow-skipped", action="store_true",
+                        help="don't fail on suites that were skipped")
+    parser.add_argument("--allow-missing", action="store_true",
+                        help="don't fail on baseline results that are missing")
+    parser.add_argument("--update", action="store_true",
+                        help="write the results to BASELINE instead of comparing")
+    args = parser.parse_args()
+
+    current, skipped = load_results(args.results)
+
+    if args.update:
+        if skipped and not args.allow_skipped:
+            print("Refusing to store a baseline with skipped suites")
+            return 1
+        with open(args.baseline, "w") as f:
+            json.dump({"results": sorted(current.values(), key=lambda r: r["name"])},
+                      f, indent=2)
+            f.write("\n")
+        print(f"Stored {len(current)} results in {args.baseline}")
+        return 0
+
+    baseline, _ = load_results([args.baseline])
+    regressions = 0
+    mismatched = 0
+    print(f"{'benchmark':32} {'base(ns)':>12} {'now(ns)':>12} {'change':>8}")
+    for name, cur in sorted(current.items()):
+        base = baseline.get(name)
+        if base is None:
+            print(f"{name:32} {'-':>12} {cur['median']:12.0f} {'new':>8}")
+            continue
+        if cur["buildtype"] != base["buildtype"]:
+            print(f"{name:32} buildtype {cur['buildtype']} vs baseline "
+                  f"{base['buildtype']}  FAIL")
+            mismatched += 1
+            continue
+        delta = cur["median"] - base["median"]
+        change = delta / base["median"] if base["median"] else 0.0
+        noise = args.mad_factor * max(cur["mad"], base["mad"])
+        regressed = change > args.threshold and delta > noise
+        regressions += regressed
+        print(f"{name:32} {base['median']:12.0f} {cur['median']:12.0f} "
+              f"{change:+8.1%}{'  REGRESSION' if regressed else ''}")
+
+    missing = 0
+    for name in sorted(baseline.keys() - current.keys()):
+        if baseline[name]["suite"] in skipped:
+            allowed = args.allow_skipped
+            print(f"{name:32} skipped{'' if allowed else '  FAIL'}")
+        else:
+            allowed = args.allow_missing
+            print(f"{name:32} missing from results{'' if allowed else '  FAIL'}")
+        missing += not allowed
+
+    if skipped and not args.allow_skipped:
+        print(f"{len(skipped)} suite(s) skipped")
+    if missing:
+        print(f"{missing} baseline result(s) not measured")
+    if mismatched:
+        print(f"{mismatched} result(s) built with a different buildtype")
+    if regressions:
+        print(f"{regressions} regression(s) found")
+    if regressions or missing or mismatched or (skipped and not args.allow_skipped):
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -131,6 +131,14 @@ static int init_debug_messenger(vulkan_context *vkctx,
   }
 }
 
+static void destroy_debug_messenger(vulkan_context *vkctx) {
+  PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT =
+      (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(
+          vkctx->instance, "vkDestroyDebugUtilsMessengerEXT");
+  vkDestroyDebugUtilsMessengerEXT(vkctx->instance, vkctx->debug_messenger,
+                                  NULL);
+}
+
 static int init_vulkan_instance(vulkan_context *vkctx,
                                 struct vulkan_context_opts *opts) {
   VkApplicationInfo app_info = {};
@@ -428,6 +436,29 @@ static int init_window_surface(vulkan_context *vkctx,
   }
 }
 
+static const char *phase_names[VKCTX_PHASE_COUNT] = {
+    [VKCTX_PHASE_WINDOW] = "window",
+    [VKCTX_PHASE_INSTANCE] = "instance",
+    [VKCTX_PHASE_DEBUG_MESSENGER] = "debug_messenger",
+    [VKCTX_PHASE_SURFACE] = "surface",
+    [VKCTX_PHASE_PHYSICAL_DEVICE] = "physical_device",
+    [VKCTX_PHASE_LOGICAL_DEVICE] = "logical_device",
+};
+
+const char *vulkan_context_phase_name(enum vulkan_context_phase phase) {
+  if ((unsigned)phase >= VKCTX_PHASE_COUNT) {
+    return NULL;
+  }
+  return phase_names[phase];
+}
+
+static void phase_done(struct vulkan_context_opts *opts,
+                       enum vulkan_context_phase phase) {
+  if (opts->phase_done) {
+    opts->phase_done(phase, opts->phase_user_data);
+  }
+}
+
 int init_vulkan_context(vulkan_context **vkctx_out,
                         struct vulkan_context_opts *opts) {
   assert(opts);
@@ -438,21 +469,29 @@ int init_vulkan_context(vulkan_context **vkctx_out,
   if (init_window_glfw(vkctx, opts) < 0) {
     goto exit_free_context;
   }
+  phase_done(opts, VKCTX_PHASE_WINDOW);
   if (init_vulkan_instance(vkctx, opts) < 0) {
     goto exit_destroy_window;
   }
+  phase_done(opts, VKCTX_PHASE_INSTANCE);
   if (opts->enable_validation) {
-    init_debug_messenger(vkctx, opts);
+    /*A missing debug messenger is not fatal, but don't report it as done*/
+    if (init_debug_messenger(vkctx, opts) == 0) {
+      phase_done(opts, VKCTX_PHASE_DEBUG_MESSENGER);
+    }
   }
   if (init_window_surface(vkctx, opts) < 0) {
     goto exit_destroy_instance;
   }
+  phase_done(opts, VKCTX_PHASE_SURFACE);
   if (init_physical_device(vkctx, opts) < 0) {
     goto exit_destroy_surface;
   }
+  phase_done(opts, VKCTX_PHASE_PHYSICAL_DEVICE);
   if (init_logical_device(vkctx, opts) < 0) {
     goto exit_destroy_surface;
   }
+  phase_done(opts, VKCTX_PHASE_LOGICAL_DEVICE);
 
   *vkctx_out = vkctx;
   return 0;
@@ -460,11 +499,7 @@ exit_destroy_surface:
   vkDestroySurfaceKHR(vkctx->instance, vkctx->surface, NULL);
 exit_destroy_instance:
   if (vkctx->debug_messenger) {
-    PFN_vkDestroyDebugUtilsMessengerEXT vkDestroyDebugUtilsMessengerEXT =
-        (PFN_vkDestroyDebugUtilsMessengerEXT)vkGetInstanceProcAddr(
-            vkctx->instance, "vkDestroyDebugUtilsMessengerEXT");
-    vkDestroyDebugUtilsMessengerEXT(vkctx->instance, vkctx->debug_messenger,
-                                    NULL);
+    destroy_debug_messenger(vkctx);
   }
   vkDestroyInstance(vkctx->instance, NULL);
 exit_destroy_window:
@@ -476,6 +511,19 @@ exit_free_context:
   return -1;
 }
 
+void destroy_vulkan_context(vulkan_context *vkctx) {
+  assert(vkctx);
+  /*Teardown happens in reverse order of init_vulkan_context*/
+  vkDestroyDevice(vkctx->device, NULL);
+  vkDestroySurfaceKHR(vkctx->instance, vkctx->surface, NULL);
+  if (vkctx->debug_messenger) {
+    destroy_debug_messenger(vkctx);
+  }
+  vkDestroyInstance(vkctx->instance, NULL);
+  glfwDestroyWindow(vkctx->window);
+  xfree(vkctx);
+}
+
 void temp_glfw_loop(vulkan_context *vkctx) {
   assert(vkctx->window);
   while (!glfwWindowShouldClose(vkctx->window)) {
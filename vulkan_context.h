@@ -12,10 +12,30 @@ struct device_opts {
   const char *device_name;
 };
 
+/* Initialization phases of init_vulkan_context, in the order they run.
+ * VKCTX_PHASE_DEBUG_MESSENGER is only reported when validation is enabled. */
+enum vulkan_context_phase {
+  VKCTX_PHASE_WINDOW,
+  VKCTX_PHASE_INSTANCE,
+  VKCTX_PHASE_DEBUG_MESSENGER,
+  VKCTX_PHASE_SURFACE,
+  VKCTX_PHASE_PHYSICAL_DEVICE,
+  VKCTX_PHASE_LOGICAL_DEVICE,
+  VKCTX_PHASE_COUNT
+};
+
+/* Called by init_vulkan_context after each initialization phase finished
+ * successfully */
+typedef void (*vulkan_context_phase_fn)(enum vulkan_context_phase phase,
+                                        void *user_data);
+
 struct vulkan_context_opts {
   struct window_opts w_opts;
   struct device_opts d_opts;
   int enable_validation : 1;
+  /*Optional, may be NULL*/
+  vulkan_context_phase_fn phase_done;
+  void *phase_user_data;
 };
 
 /* Handle representing a fully functional vulkan context. (Instance, Device,
@@ -25,5 +45,10 @@ typedef struct vulkan_context vulkan_context;
 int init_vulkan_context(vulkan_context **vkctx,
                         struct vulkan_context_opts *opts);
 
+void destroy_vulkan_context(vulkan_context *vkctx);
+
+/* Returns a static name like "instance" for phase, NULL if out of range */
+const char *vulkan_context_phase_name(enum vulkan_context_phase phase);
+
 void temp_glfw_loop(vulkan_context *vkctx);
 #endif